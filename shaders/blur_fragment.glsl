@@ -0,0 +1,19 @@
+#version 330 core
+in vec2 texCoord;
+out vec4 FragColor;
+
+uniform sampler2D sourceTexture;
+uniform vec2 texelStep;  // One texel along the blur direction
+
+// 9-tap Gaussian, sampled as the centre plus four taps on each side
+const float weights[5] = float[](0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216);
+
+void main()
+{
+    vec3 color = texture(sourceTexture, texCoord).rgb * weights[0];
+    for (int i = 1; i < 5; ++i) {
+        color += texture(sourceTexture, texCoord + texelStep * float(i)).rgb * weights[i];
+        color += texture(sourceTexture, texCoord - texelStep * float(i)).rgb * weights[i];
+    }
+    FragColor = vec4(color, 1.0);
+} 
\ No newline at end of file
@@ -0,0 +1,13 @@
+#version 330 core
+in vec2 texCoord;
+out vec4 FragColor;
+
+uniform sampler2D sourceTexture;
+uniform float threshold;  // Luminance above which pixels start to glow
+
+void main()
+{
+    vec3 color = texture(sourceTexture, texCoord).rgb;
+    float brightness = dot(color, vec3(0.2126, 0.7152, 0.0722));
+    FragColor = vec4(color * smoothstep(threshold, threshold + 0.1, brightness), 1.0);
+} 
\ No newline at end of file
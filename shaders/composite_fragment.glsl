@@ -0,0 +1,24 @@
+#version 330 core
+in vec2 texCoord;
+out vec4 FragColor;
+
+uniform sampler2D sceneTexture;
+uniform sampler2D bloomTexture;
+uniform bool bloomEnabled;
+uniform bool toneMapping;
+uniform float exposure;
+
+void main()
+{
+    vec3 color = texture(sceneTexture, texCoord).rgb;
+    if (bloomEnabled) {
+        color += texture(bloomTexture, texCoord).rgb;
+    }
+    color *= exposure;
+
+    // Reinhard tone mapping brings HDR values back into the displayable range
+    if (toneMapping) {
+        color = color / (color + vec3(1.0));
+    }
+    FragColor = vec4(color, 1.0);
+} 
\ No newline at end of file
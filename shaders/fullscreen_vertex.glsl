@@ -0,0 +1,9 @@
+#version 330 core
+out vec2 texCoord;
+
+void main() {
+    // One triangle covering the whole screen, generated from the vertex index
+    vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    texCoord = pos;
+    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+} 
\ No newline at end of file
@@ -0,0 +1,11 @@
+#version 330 core
+in vec3 texCoord;
+out vec4 FragColor;
+
+uniform sampler2DArray spriteTexture;  // Bound to texture unit 0
+uniform vec4 shapeColor;                // Tint applied to every sprite
+
+void main()
+{
+    FragColor = texture(spriteTexture, texCoord) * shapeColor;
+} 
\ No newline at end of file
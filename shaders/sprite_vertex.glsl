@@ -0,0 +1,10 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aTexCoord;  // uv and texture array layer
+
+out vec3 texCoord;
+
+void main() {
+    gl_Position = vec4(aPos, 1.0);
+    texCoord = aTexCoord;
+} 
\ No newline at end of file
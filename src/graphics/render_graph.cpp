@@ -0,0 +1,314 @@
+#include <algorithm>
+#include <iostream>
+#include "render_graph.h"
+
+RenderGraph::RenderGraph() : resources(), passes(), executionOrder(), targets(), stats() {
+}
+
+RenderGraph::~RenderGraph() {
+    cleanup();
+}
+
+void RenderGraph::reset() {
+    resources.clear();
+    passes.clear();
+    executionOrder.clear();
+}
+
+RenderResource RenderGraph::createTexture(const std::string& name, const RenderTargetDesc& desc) {
+    resources.push_back(Resource{name, desc, false, -1, -1});
+    return static_cast<RenderResource>(resources.size() - 1);
+}
+
+RenderResource RenderGraph::importBackbuffer(const std::string& name, int width, int height) {
+    resources.push_back(Resource{name, RenderTargetDesc{width, height, GL_RGBA8}, true, -1, -1});
+    return static_cast<RenderResource>(resources.size() - 1);
+}
+
+bool RenderGraph::isValid(RenderResource resource) const {
+    return resource >= 0 && resource < static_cast<RenderResource>(resources.size());
+}
+
+void RenderGraph::addPass(const std::string& name, const std::vector<RenderResource>& reads,
+                          RenderResource write, PassCallback callback) {
+    if (!isValid(write)) {
+        std::cerr << "Render pass " << name << " has no valid output" << std::endl;
+        return;
+    }
+    for (RenderResource read : reads) {
+        if (!isValid(read) || read == write) {
+            std::cerr << "Render pass " << name << " has an invalid input" << std::endl;
+            return;
+        }
+    }
+    Resource& output = resources[write];
+    if (output.writer != -1) {
+        std::cerr << "Render pass " << name << " writes " << output.name
+                  << ", which is already written by " << passes[output.writer].name << std::endl;
+        return;
+    }
+
+    output.writer = static_cast<int>(passes.size());
+    passes.push_back(Pass{name, reads, write, std::move(callback), false});
+}
+
+void RenderGraph::cullPasses() {
+    // Walk backwards from the passes that write imported resources
+    std::vector<int> pending;
+    for (size_t i = 0; i < passes.size(); ++i) {
+        passes[i].live = resources[passes[i].write].imported;
+        if (passes[i].live) {
+            pending.push_back(static_cast<int>(i));
+        }
+    }
+
+    while (!pending.empty()) {
+        const Pass& pass = passes[pending.back()];
+        pending.pop_back();
+        for (RenderResource read : pass.reads) {
+            int writer = resources[read].writer;
+            if (writer == -1) {
+                std::cerr << "Render pass " << pass.name << " reads " << resources[read].name
+                          << ", which no pass writes" << std::endl;
+            } else if (!passes[writer].live) {
+                passes[writer].live = true;
+                pending.push_back(writer);
+            }
+        }
+    }
+}
+
+bool RenderGraph::orderPasses() {
+    // Kahn's algorithm, picking the earliest declared ready pass to keep the
+    // order predictable
+    std::vector<int> dependencies(passes.size(), 0);
+    size_t liveCount = 0;
+    for (size_t i = 0; i < passes.size(); ++i) {
+        if (!passes[i].live) continue;
+        liveCount++;
+        for (RenderResource read : passes[i].reads) {
+            if (resources[read].writer != -1) {
+                dependencies[i]++;
+            }
+        }
+    }
+
+    std::vector<bool> scheduled(passes.size(), false);
+    executionOrder.clear();
+    while (executionOrder.size() < liveCount) {
+        int next = -1;
+        for (size_t i = 0; i < passes.size(); ++i) {
+            if (passes[i].live && !scheduled[i] && dependencies[i] == 0) {
+                next = static_cast<int>(i);
+                break;
+            }
+        }
+        if (next == -1) {
+            std::cerr << "Render graph has a dependency cycle" << std::endl;
+            return false;
+        }
+
+        scheduled[next] = true;
+        executionOrder.push_back(next);
+        for (size_t i = 0; i < passes.size(); ++i) {
+            if (!passes[i].live || scheduled[i]) continue;
+            for (RenderResource read : passes[i].reads) {
+                if (resources[read].writer == next) {
+                    dependencies[i]--;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool RenderGraph::assignTargets() {
+    struct Lifetime {
+        RenderResource resource;
+        int first;
+        int last;
+    };
+
+    // Lifetime of each transient, as positions in the execution order
+    std::vector<Lifetime> lifetimes;
+    for (size_t position = 0; position < executionOrder.size(); ++position) {
+        const Pass& pass = passes[executionOrder[position]];
+        if (!resources[pass.write].imported) {
+            lifetimes.push_back(Lifetime{pass.write, static_cast<int>(position), static_cast<int>(position)});
+        }
+    }
+    for (size_t position = 0; position < executionOrder.size(); ++position) {
+        for (RenderResource read : passes[executionOrder[position]].reads) {
+            for (Lifetime& lifetime : lifetimes) {
+                if (lifetime.resource == read) {
+                    lifetime.last = std::max(lifetime.last, static_cast<int>(position));
+                }
+            }
+        }
+    }
+
+    for (RenderTarget& target : targets) {
+        target.used = false;
+        target.lastUse = -1;
+    }
+
+    auto matches = [](const RenderTargetDesc& a, const RenderTargetDesc& b) {
+        return a.width == b.width && a.height == b.height && a.internalFormat == b.internalFormat;
+    };
+
+    // lifetimes is already sorted by first use
+    for (const Lifetime& lifetime : lifetimes) {
+        Resource& resource = resources[lifetime.resource];
+        int chosen = -1;
+
+        // Prefer a target another transient has finished with, then a cached
+        // one nothing has claimed yet
+        for (size_t i = 0; i < targets.size() && chosen == -1; ++i) {
+            if (targets[i].used && targets[i].lastUse < lifetime.first && matches(targets[i].desc, resource.desc)) {
+                chosen = static_cast<int>(i);
+            }
+        }
+        for (size_t i = 0; i < targets.size() && chosen == -1; ++i) {
+            if (!targets[i].used && matches(targets[i].desc, resource.desc)) {
+                chosen = static_cast<int>(i);
+            }
+        }
+        if (chosen == -1) {
+            RenderTarget target{resource.desc, 0, 0, -1, false};
+            if (!createTarget(target)) {
+                return false;  // Already reported; the caller skips the graph this frame
+            }
+            targets.push_back(target);
+            chosen = static_cast<int>(targets.size() - 1);
+        }
+
+        targets[chosen].used = true;
+        targets[chosen].lastUse = lifetime.last;
+        resource.physical = chosen;
+
+        stats.transientCount++;
+        stats.unaliasedBytes += resource.desc.width * static_cast<size_t>(resource.desc.height) *
+                                bytesPerPixel(resource.desc.internalFormat);
+    }
+
+    // Free targets nothing needs any more (e.g. after a resize) and fix up indices
+    std::vector<int> remap(targets.size(), -1);
+    size_t kept = 0;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        if (!targets[i].used) {
+            destroyTarget(targets[i]);
+            continue;
+        }
+        remap[i] = static_cast<int>(kept);
+        targets[kept++] = targets[i];
+    }
+    targets.resize(kept);
+    for (Resource& resource : resources) {
+        if (resource.physical != -1) {
+            resource.physical = remap[resource.physical];
+        }
+    }
+
+    for (const RenderTarget& target : targets) {
+        stats.physicalCount++;
+        stats.peakBytes += target.desc.width * static_cast<size_t>(target.desc.height) *
+                           bytesPerPixel(target.desc.internalFormat);
+    }
+    stats.savedBytes = stats.unaliasedBytes - stats.peakBytes;
+    return true;
+}
+
+bool RenderGraph::compile() {
+    stats = RenderGraphStats();
+    stats.passCount = static_cast<int>(passes.size());
+
+    cullPasses();
+    if (!orderPasses()) {
+        return false;
+    }
+    stats.culledPassCount = stats.passCount - static_cast<int>(executionOrder.size());
+
+    if (!assignTargets()) {
+        executionOrder.clear();  // Nothing runs until a later compile succeeds
+        return false;
+    }
+    return true;
+}
+
+void RenderGraph::execute() {
+    for (int index : executionOrder) {
+        Pass& pass = passes[index];
+        const Resource& output = resources[pass.write];
+
+        // compile() only succeeds once every live transient has a target
+        GLuint framebuffer = output.imported ? 0 : targets[output.physical].framebuffer;
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glViewport(0, 0, output.desc.width, output.desc.height);
+
+        pass.callback();
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+GLuint RenderGraph::getTexture(RenderResource resource) const {
+    if (!isValid(resource) || resources[resource].physical == -1) {
+        return 0;
+    }
+    return targets[resources[resource].physical].texture;
+}
+
+bool RenderGraph::createTarget(RenderTarget& target) {
+    glGenTextures(1, &target.texture);
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, target.desc.internalFormat, target.desc.width, target.desc.height,
+                 0, GL_RGBA, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &target.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.texture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Render target " << target.desc.width << "x" << target.desc.height
+                  << " is incomplete: 0x" << std::hex << status << std::dec << std::endl;
+        destroyTarget(target);
+        return false;
+    }
+    return true;
+}
+
+void RenderGraph::destroyTarget(RenderTarget& target) {
+    if (target.framebuffer) {
+        glDeleteFramebuffers(1, &target.framebuffer);
+        target.framebuffer = 0;
+    }
+    if (target.texture) {
+        glDeleteTextures(1, &target.texture);
+        target.texture = 0;
+    }
+}
+
+size_t RenderGraph::bytesPerPixel(GLenum internalFormat) {
+    switch (internalFormat) {
+        case GL_RGBA16F:
+            return 8;
+        case GL_RGBA32F:
+            return 16;
+        default:  // GL_RGBA8 and friends
+            return 4;
+    }
+}
+
+void RenderGraph::cleanup() {
+    for (RenderTarget& target : targets) {
+        destroyTarget(target);
+    }
+    targets.clear();
+    reset();
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+using RenderResource = int;  // Handle returned by RenderGraph, -1 is invalid
+
+struct RenderTargetDesc {
+    int width;
+    int height;
+    GLenum internalFormat;  // e.g. GL_RGBA8, GL_RGBA16F
+};
+
+// Numbers from the last compile
+struct RenderGraphStats {
+    int passCount = 0;
+    int culledPassCount = 0;
+    int transientCount = 0;     // Transient textures used by live passes
+    int physicalCount = 0;      // Render targets actually allocated for them
+    size_t unaliasedBytes = 0;  // Memory needed with one target per transient
+    size_t peakBytes = 0;       // Memory of the allocated targets, all live at once
+    size_t savedBytes = 0;
+};
+
+// Small frame graph for post-processing. Every frame the renderer declares
+// its resources and passes, then compiles and executes the graph:
+//   - passes that do not contribute to an imported resource are culled
+//   - the remaining passes are ordered so each runs after its inputs' writers
+//   - transient textures whose lifetimes do not overlap share one render target
+// Render targets are cached between frames and only recreated when the
+// declared sizes or formats change.
+class RenderGraph {
+public:
+    using PassCallback = std::function<void()>;
+
+    RenderGraph();
+    ~RenderGraph();
+
+    void reset();  // Drop last frame's declarations, keep the cached targets
+    RenderResource createTexture(const std::string& name, const RenderTargetDesc& desc);
+    RenderResource importBackbuffer(const std::string& name, int width, int height);
+    void addPass(const std::string& name, const std::vector<RenderResource>& reads,
+                 RenderResource write, PassCallback callback);
+
+    bool compile();  // False if the graph has a cycle or a render target cannot be created
+    void execute();  // Leaves the default framebuffer bound
+    void cleanup();
+
+    // Texture backing a resource; only valid while the graph is executing
+    GLuint getTexture(RenderResource resource) const;
+    const RenderGraphStats& getStats() const { return stats; }
+
+private:
+    struct Resource {
+        std::string name;
+        RenderTargetDesc desc;
+        bool imported;
+        int writer;    // Pass index, -1 if nothing writes it
+        int physical;  // Index into targets, -1 for imported resources
+    };
+
+    struct Pass {
+        std::string name;
+        std::vector<RenderResource> reads;
+        RenderResource write;
+        PassCallback callback;
+        bool live;
+    };
+
+    struct RenderTarget {
+        RenderTargetDesc desc;
+        GLuint framebuffer;
+        GLuint texture;
+        int lastUse;  // Position in the execution order, for aliasing
+        bool used;    // Claimed during the current compile
+    };
+
+    bool isValid(RenderResource resource) const;
+    void cullPasses();
+    bool orderPasses();
+    bool assignTargets();
+    bool createTarget(RenderTarget& target);
+    void destroyTarget(RenderTarget& target);
+    static size_t bytesPerPixel(GLenum internalFormat);
+
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    std::vector<int> executionOrder;    // Live pass indices
+    std::vector<RenderTarget> targets;  // Cached across frames
+    RenderGraphStats stats;
+};
@@ -0,0 +1,201 @@
+#include <algorithm>
+#include "render_queue.h"
+
+namespace {
+    const int LAYER_BITS = 8;
+    const int BLEND_BITS = 2;
+    const int PROGRAM_BITS = 12;
+    const int MESH_BITS = 16;
+    const int DEPTH_BITS = 26;
+
+    const uint64_t PROGRAM_MASK = (1ull << PROGRAM_BITS) - 1;
+    const uint64_t MESH_MASK = (1ull << MESH_BITS) - 1;
+    const uint64_t DEPTH_MASK = (1ull << DEPTH_BITS) - 1;
+
+    const int BLEND_SHIFT = 64 - LAYER_BITS - BLEND_BITS;
+
+    uint64_t quantizeDepth(float depth) {
+        // float cannot hold DEPTH_MASK exactly (it rounds up to 2^26), so scale in double
+        double clamped = std::clamp(static_cast<double>(depth), 0.0, 1.0);
+        return std::min(static_cast<uint64_t>(clamped * static_cast<double>(DEPTH_MASK)), DEPTH_MASK);
+    }
+}
+
+RenderQueue::RenderQueue() : sortingEnabled(true) {
+}
+
+uint64_t RenderQueue::makeKey(const DrawItem& item, uint8_t layer, float depth) {
+    uint64_t key = static_cast<uint64_t>(layer) << (64 - LAYER_BITS);
+    key |= static_cast<uint64_t>(item.blend) << BLEND_SHIFT;
+
+    // GL names are small sequential integers, so the low bits are enough to group by
+    uint64_t program = item.program & PROGRAM_MASK;
+    uint64_t mesh = item.vao & MESH_MASK;
+    uint64_t quantized = quantizeDepth(depth);
+
+    if (item.blend == BlendMode::Opaque) {
+        // Group by state, then draw front-to-back for early depth rejection
+        key |= program << (MESH_BITS + DEPTH_BITS);
+        key |= mesh << DEPTH_BITS;
+        key |= quantized;
+    } else {
+        // Back-to-front so blending composites correctly
+        key |= (DEPTH_MASK - quantized) << (PROGRAM_BITS + MESH_BITS);
+        key |= program << MESH_BITS;
+        key |= mesh;
+    }
+    return key;
+}
+
+void RenderQueue::submit(const DrawItem& item, uint8_t layer, float depth) {
+    items.push_back(item);
+    keys.push_back(makeKey(item, layer, depth));
+}
+
+void RenderQueue::clear() {
+    items.clear();
+    keys.clear();
+}
+
+void RenderQueue::radixSort() {
+    // LSD radix sort on 8-bit digits. It is stable, so items with equal keys
+    // keep their submission order.
+    size_t count = keys.size();
+    keyScratch.resize(count);
+    orderScratch.resize(count);
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+        for (size_t i = 0; i < count; ++i) {
+            histogram[(keys[i] >> shift) & 0xFF]++;
+        }
+
+        // All keys share this digit, nothing would move
+        if (histogram[(keys[0] >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t& bucket : histogram) {
+            size_t bucketSize = bucket;
+            bucket = offset;
+            offset += bucketSize;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            size_t destination = histogram[(keys[i] >> shift) & 0xFF]++;
+            keyScratch[destination] = keys[i];
+            orderScratch[destination] = order[i];
+        }
+        keys.swap(keyScratch);
+        order.swap(orderScratch);
+    }
+}
+
+int RenderQueue::countStateChanges(const std::vector<uint32_t>& sequence) const {
+    int changes = 0;
+    GLuint program = 0;
+    GLuint vao = 0;
+    GLuint texture = 0;
+    bool haveBlend = false;
+    BlendMode blend = BlendMode::Opaque;
+
+    for (uint32_t index : sequence) {
+        const DrawItem& item = items[index];
+        if (item.program != program) {
+            program = item.program;
+            changes++;
+        }
+        if (item.vao != vao) {
+            vao = item.vao;
+            changes++;
+        }
+        if (item.texture && item.texture != texture) {
+            texture = item.texture;
+            changes++;
+        }
+        if (!haveBlend || item.blend != blend) {
+            blend = item.blend;
+            haveBlend = true;
+            changes++;
+        }
+    }
+    return changes;
+}
+
+void RenderQueue::execute() {
+    stats = RenderQueueStats();
+    stats.itemCount = items.size();
+    if (items.empty()) {
+        return;
+    }
+
+    submissionOrder.resize(items.size());
+    for (uint32_t i = 0; i < submissionOrder.size(); ++i) {
+        submissionOrder[i] = i;
+    }
+    order = submissionOrder;
+
+    // keys is permuted by the sort, but it is cleared below so that is fine
+    radixSort();
+    stats.unsortedStateChanges = countStateChanges(submissionOrder);
+    stats.sortedStateChanges = countStateChanges(order);
+
+    const std::vector<uint32_t>& sequence = sortingEnabled ? order : submissionOrder;
+
+    GLuint currentProgram = 0;
+    GLuint currentVAO = 0;
+    GLuint currentTexture = 0;
+    bool haveBlend = false;
+    BlendMode currentBlend = BlendMode::Opaque;
+
+    for (uint32_t index : sequence) {
+        const DrawItem& item = items[index];
+
+        if (item.program != currentProgram) {
+            glUseProgram(item.program);
+            currentProgram = item.program;
+            stats.programChanges++;
+        }
+        if (item.vao != currentVAO) {
+            glBindVertexArray(item.vao);
+            currentVAO = item.vao;
+            stats.vaoChanges++;
+        }
+        // Untextured programs ignore the binding, so only switch when a texture is needed
+        if (item.texture && item.texture != currentTexture) {
+            glBindTexture(GL_TEXTURE_2D_ARRAY, item.texture);
+            currentTexture = item.texture;
+            stats.textureChanges++;
+        }
+        if (!haveBlend || item.blend != currentBlend) {
+            if (item.blend == BlendMode::AlphaBlend) {
+                glEnable(GL_BLEND);
+            } else {
+                glDisable(GL_BLEND);
+            }
+            currentBlend = item.blend;
+            haveBlend = true;
+            stats.blendChanges++;
+        }
+
+        if (item.colorLocation != -1) {
+            glUniform4f(item.colorLocation, item.color[0], item.color[1], item.color[2], item.color[3]);
+        }
+
+        if (item.indexed) {
+            glDrawElements(item.primitive, item.count, GL_UNSIGNED_INT, 0);
+        } else {
+            glDrawArrays(item.primitive, 0, item.count);
+        }
+    }
+
+    // Leave the state the rest of the frame (FPS text, GUI) expects
+    glBindVertexArray(0);
+    if (currentTexture) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+    glEnable(GL_BLEND);
+
+    clear();
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstdint>
+#include <vector>
+
+// Blend state a draw item needs; opaque items always sort ahead of blended ones
+enum class BlendMode : uint8_t {
+    Opaque = 0,
+    AlphaBlend = 1
+};
+
+// Everything needed to issue one draw call
+struct DrawItem {
+    GLuint program;
+    GLuint vao;
+    GLuint texture;        // Bound as GL_TEXTURE_2D_ARRAY on unit 0 (0 for none)
+    GLenum primitive;      // e.g. GL_TRIANGLES
+    GLsizei count;         // Vertex or index count
+    bool indexed;          // glDrawElements instead of glDrawArrays
+    BlendMode blend;
+    GLint colorLocation;   // shapeColor uniform of the program (-1 to skip)
+    float color[4];
+};
+
+// Per-frame numbers reported by the queue
+struct RenderQueueStats {
+    size_t itemCount = 0;
+    int programChanges = 0;        // glUseProgram calls issued
+    int vaoChanges = 0;            // glBindVertexArray calls issued
+    int textureChanges = 0;        // glBindTexture calls issued
+    int blendChanges = 0;          // glEnable/glDisable(GL_BLEND) calls issued
+    int unsortedStateChanges = 0;  // Total changes submission order would have needed
+    int sortedStateChanges = 0;    // Total changes after sorting by key
+};
+
+// Collects draw items for a frame, sorts them by a packed 64-bit key and
+// executes them with redundant program/VAO/blend changes filtered out.
+//
+// Key layout, most significant bits first:
+//   opaque:  layer(8) | blend(2) | program(12) | mesh(16) | depth(26, front-to-back)
+//   blended: layer(8) | blend(2) | depth(26, back-to-front) | program(12) | mesh(16)
+// Blended items have to be drawn in depth order to composite correctly, so
+// depth outranks state for them; opaque items are grouped by state instead.
+// Textures are not part of the key: sprites share one array texture, so the
+// program already separates textured from untextured items.
+class RenderQueue {
+public:
+    RenderQueue();
+
+    // depth is expected in [0, 1], 0 being nearest to the viewer
+    void submit(const DrawItem& item, uint8_t layer = 0, float depth = 0.0f);
+    // Draw in key order (or submission order with sorting off) and clear the
+    // queue. The sort always runs so the stats can compare both orders.
+    void execute();
+    void clear();
+
+    void setSortingEnabled(bool enabled) { sortingEnabled = enabled; }
+    bool isSortingEnabled() const { return sortingEnabled; }
+    const RenderQueueStats& getStats() const { return stats; }
+
+    static uint64_t makeKey(const DrawItem& item, uint8_t layer, float depth);
+
+private:
+    void radixSort();
+    int countStateChanges(const std::vector<uint32_t>& sequence) const;
+
+    std::vector<DrawItem> items;
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> order;    // Indices into items, in execution order
+    std::vector<uint64_t> keyScratch;
+    std::vector<uint32_t> orderScratch;
+    std::vector<uint32_t> submissionOrder;
+    bool sortingEnabled;
+    RenderQueueStats stats;
+};
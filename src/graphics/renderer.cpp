@@ -2,6 +2,7 @@
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <algorithm>
 #include <GL/glew.h>  // GLEW must be included first
 #define GLUT_NO_LIB_PRAGMA  // Prevent GLUT from defining APIENTRY
 #include <GL/glut.h>
@@ -14,6 +15,8 @@ Renderer::Renderer(int width, int height) : window(nullptr),
                                             triangleVAO(0), triangleVBO(0),
                                             squareVAO(0), squareVBO(0),
                                             circleVAO(0), circleVBO(0),
+                                            spriteVAO(0), spriteVBO(0),
+                                            fullscreenVAO(0),
                                             windowWidth(width),
                                             windowHeight(height),
                                             showFPS(false),
@@ -26,7 +29,18 @@ Renderer::Renderer(int width, int height) : window(nullptr),
                                             time(0.0f),
                                             rainbowMode(true),
                                             animationSpeed(1.0f),
-                                            currentShape(0) {
+                                            currentShape(0),
+                                            renderQueue(),
+                                            textureLoader(256, 16, 2),
+                                            sprites(),
+                                            spriteVertices(),
+                                            showSprites(true),
+                                            renderGraph(),
+                                            blurEnabled(false),
+                                            bloomEnabled(false),
+                                            toneMappingEnabled(false),
+                                            exposure(1.0f),
+                                            bloomThreshold(0.7f) {
     lastTime = glfwGetTime();
     backgroundColor[0] = 0.2f;
     backgroundColor[1] = 0.3f;
@@ -77,6 +91,15 @@ bool Renderer::init() {
     createSquare();
     createCircle();
     createTriangle();
+    createSpriteBatch();
+
+    // Full-screen passes generate their vertices in the shader but still need a VAO bound
+    glGenVertexArrays(1, &fullscreenVAO);
+
+    // Sprite textures are decoded on worker threads and streamed into one texture array
+    if (!textureLoader.init()) {
+        return false;
+    }
 
     return true;
 }
@@ -101,12 +124,12 @@ std::string Renderer::loadShader(const std::string& filePath) {
     return shaderStream.str();
 }
 
-bool Renderer::loadShaders(const std::string& name, const std::string& vertexShaderPath, const std::string& fragmentShaderPath) {
+GLuint Renderer::compileProgram(const std::string& vertexShaderPath, const std::string& fragmentShaderPath) {
     std::string vertexShaderSource = loadShader(vertexShaderPath);
     std::string fragmentShaderSource = loadShader(fragmentShaderPath);
 
     if (vertexShaderSource.empty() || fragmentShaderSource.empty()) {
-        return false;
+        return 0;
     }
 
     GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
@@ -132,10 +155,20 @@ bool Renderer::loadShaders(const std::string& name, const std::string& vertexSha
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
+    return shaderProgram;
+}
+
+bool Renderer::loadShaders(const std::string& name, const std::string& vertexShaderPath, const std::string& fragmentShaderPath) {
+    GLuint shaderProgram = compileProgram(vertexShaderPath, fragmentShaderPath);
+    if (!shaderProgram) {
+        return false;
+    }
+
     // Get uniform location after shader program is created and linked
     GLint colorUniformLocation = glGetUniformLocation(shaderProgram, "shapeColor");
     if (colorUniformLocation == -1) {
         std::cerr << "Failed to get uniform location for shapeColor in shader: " << name << std::endl;
+        glDeleteProgram(shaderProgram);
         return false;
     }
 
@@ -146,6 +179,39 @@ bool Renderer::loadShaders(const std::string& name, const std::string& vertexSha
     return true;
 }
 
+bool Renderer::loadPostProcessShaders(const std::string& name, const std::string& vertexShaderPath, const std::string& fragmentShaderPath) {
+    // Full-screen passes have no shapeColor, so cache every active uniform instead
+    GLuint shaderProgram = compileProgram(vertexShaderPath, fragmentShaderPath);
+    if (!shaderProgram) {
+        return false;
+    }
+
+    std::map<std::string, GLint>& locations = postProcessUniformLocations[name];
+    locations.clear();
+    GLint uniformCount = 0;
+    glGetProgramiv(shaderProgram, GL_ACTIVE_UNIFORMS, &uniformCount);
+    for (GLint i = 0; i < uniformCount; ++i) {
+        GLchar uniformName[64];
+        GLint size;
+        GLenum type;
+        glGetActiveUniform(shaderProgram, static_cast<GLuint>(i), sizeof(uniformName), NULL, &size, &type, uniformName);
+        locations[uniformName] = glGetUniformLocation(shaderProgram, uniformName);
+    }
+
+    shaderPrograms[name] = shaderProgram;
+    return true;
+}
+
+GLint Renderer::getPostProcessUniform(const std::string& shader, const std::string& uniform) {
+    // -1 makes glUniform* a no-op, same as for a uniform the compiler optimised out
+    auto program = postProcessUniformLocations.find(shader);
+    if (program == postProcessUniformLocations.end()) {
+        return -1;
+    }
+    auto location = program->second.find(uniform);
+    return location == program->second.end() ? -1 : location->second;
+}
+
 void Renderer::checkShaderCompileErrors(GLuint shader, const std::string& type) {
     GLint success;
     GLchar infoLog[512];
@@ -307,6 +373,86 @@ void Renderer::createTriangle() {
     glEnableVertexAttribArray(0);
 }
 
+void Renderer::createSpriteBatch() {
+    // Vertices are written every frame: position (xyz) followed by texture coordinate (uv, layer)
+    glGenVertexArrays(1, &spriteVAO);
+    glGenBuffers(1, &spriteVBO);
+
+    glBindVertexArray(spriteVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, spriteVBO);
+    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STREAM_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+}
+
+int Renderer::loadSpriteTexture(const std::string& filePath) {
+    std::filesystem::path path(filePath);
+    if (!std::filesystem::exists(path)) {
+        std::cerr << "Texture file not found: " << std::filesystem::absolute(path) << std::endl;
+        return -1;
+    }
+    return textureLoader.load(filePath);
+}
+
+void Renderer::addSprite(int texture, float x, float y, float width, float height) {
+    if (texture < 0) return;
+    sprites.push_back(Sprite{texture, x, y, width, height});
+}
+
+void Renderer::submitSprites() {
+    // Every sprite samples the same texture array, so all of them go out in one draw
+    spriteVertices.clear();
+    for (const Sprite& sprite : sprites) {
+        if (textureLoader.getState(sprite.texture) != TextureState::Ready) {
+            continue;  // Still loading, draw it once it has been uploaded
+        }
+
+        float u, v;
+        textureLoader.getUVScale(sprite.texture, u, v);
+        float layer = static_cast<float>(sprite.texture);
+        float left = sprite.x - sprite.width * 0.5f;
+        float right = sprite.x + sprite.width * 0.5f;
+        float bottom = sprite.y - sprite.height * 0.5f;
+        float top = sprite.y + sprite.height * 0.5f;
+
+        // Image rows are stored top first, so v grows downwards
+        float quad[] = {
+            left,  bottom, 0.0f, 0.0f, v,    layer,
+            right, bottom, 0.0f, u,    v,    layer,
+            right, top,    0.0f, u,    0.0f, layer,
+            right, top,    0.0f, u,    0.0f, layer,
+            left,  top,    0.0f, 0.0f, 0.0f, layer,
+            left,  bottom, 0.0f, 0.0f, v,    layer
+        };
+        spriteVertices.insert(spriteVertices.end(), std::begin(quad), std::end(quad));
+    }
+
+    if (spriteVertices.empty()) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, spriteVBO);
+    glBufferData(GL_ARRAY_BUFFER, spriteVertices.size() * sizeof(float), spriteVertices.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    DrawItem item = {};
+    item.program = shaderPrograms["sprite"];
+    item.colorLocation = colorUniformLocations["sprite"];
+    item.vao = spriteVAO;
+    item.texture = textureLoader.getTexture();
+    item.primitive = GL_TRIANGLES;
+    item.count = static_cast<GLsizei>(spriteVertices.size() / 6);
+    item.indexed = false;
+    item.blend = BlendMode::AlphaBlend;
+    item.color[0] = 1.0f;  // No tint
+    item.color[1] = 1.0f;
+    item.color[2] = 1.0f;
+    item.color[3] = 1.0f;
+    renderQueue.submit(item, 1);  // Sprites sit on top of the shapes
+}
+
 void Renderer::cleanupShapes() {
     if (squareVAO) {
         glDeleteVertexArrays(1, &squareVAO);
@@ -324,6 +470,18 @@ void Renderer::cleanupShapes() {
         glDeleteBuffers(1, &circleVBO);
         circleVBO = 0;
     }
+    if (spriteVAO) {
+        glDeleteVertexArrays(1, &spriteVAO);
+        spriteVAO = 0;
+    }
+    if (spriteVBO) {
+        glDeleteBuffers(1, &spriteVBO);
+        spriteVBO = 0;
+    }
+    if (fullscreenVAO) {
+        glDeleteVertexArrays(1, &fullscreenVAO);
+        fullscreenVAO = 0;
+    }
 }
 
 void Renderer::render() {
@@ -331,12 +489,8 @@ void Renderer::render() {
     int display_w, display_h;
     glfwGetFramebufferSize(window, &display_w, &display_h);
     
-    // Set up the viewport
-    glViewport(0, 0, display_w, display_h);
-    
-    // Clear the screen
-    glClearColor(backgroundColor[0], backgroundColor[1], backgroundColor[2], 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+    // Stream pending texture uploads within this frame's budget
+    textureLoader.update();
 
     // Update time using real time instead of frame-based time
     double currentTime = glfwGetTime();
@@ -357,28 +511,62 @@ void Renderer::render() {
         blue = shapeColor[2];
     }
 
-    // Draw current shape
+    // Queue the current shape; the circle relies on blending for its smooth edge
+    DrawItem item = {};
+    item.primitive = GL_TRIANGLES;
+    item.color[0] = red;
+    item.color[1] = green;
+    item.color[2] = blue;
+    item.color[3] = 1.0f;
     switch (currentShape) {
         case 0:  // Triangle
-            glUseProgram(shaderPrograms["default"]);
-            glUniform4f(colorUniformLocations["default"], red, green, blue, 1.0f);
-            glBindVertexArray(triangleVAO);
-            glDrawArrays(GL_TRIANGLES, 0, 3);
+            item.program = shaderPrograms["default"];
+            item.colorLocation = colorUniformLocations["default"];
+            item.vao = triangleVAO;
+            item.count = 3;
+            item.indexed = false;
+            item.blend = BlendMode::Opaque;
+            renderQueue.submit(item);
             break;
         case 1:  // Square
-            glUseProgram(shaderPrograms["default"]);
-            glUniform4f(colorUniformLocations["default"], red, green, blue, 1.0f);
-            glBindVertexArray(squareVAO);
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+            item.program = shaderPrograms["default"];
+            item.colorLocation = colorUniformLocations["default"];
+            item.vao = squareVAO;
+            item.count = 6;
+            item.indexed = true;
+            item.blend = BlendMode::Opaque;
+            renderQueue.submit(item);
             break;
         case 2:  // Circle
-            glUseProgram(shaderPrograms["circle"]);
-            glUniform4f(colorUniformLocations["circle"], red, green, blue, 1.0f);
-            glBindVertexArray(circleVAO);
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+            item.program = shaderPrograms["circle"];
+            item.colorLocation = colorUniformLocations["circle"];
+            item.vao = circleVAO;
+            item.count = 6;
+            item.indexed = true;
+            item.blend = BlendMode::AlphaBlend;
+            renderQueue.submit(item);
             break;
     }
-    glBindVertexArray(0);
+    if (showSprites) {
+        submitSprites();
+    }
+
+    // The scene pass of the render graph executes the queue, post-processing follows
+    if (display_w > 0 && display_h > 0) {
+        buildRenderGraph(display_w, display_h);
+        if (renderGraph.compile()) {
+            renderGraph.execute();
+        } else {
+            // Skip post-processing and draw straight to the window
+            glViewport(0, 0, display_w, display_h);
+            drawScene();
+        }
+    } else {
+        renderQueue.clear();  // Minimised, nothing to draw into
+    }
+
+    // Set up the viewport for the overlays
+    glViewport(0, 0, display_w, display_h);
 
     // Update and display FPS
     updateFPS();
@@ -388,6 +576,103 @@ void Renderer::render() {
     limitFPS();
 }
 
+void Renderer::drawScene() {
+    // Clear the screen
+    glClearColor(backgroundColor[0], backgroundColor[1], backgroundColor[2], 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    renderQueue.execute();
+}
+
+void Renderer::drawFullscreen(const std::vector<RenderResource>& inputs) {
+    // Inputs are bound to consecutive texture units in the order given
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(i));
+        glBindTexture(GL_TEXTURE_2D, renderGraph.getTexture(inputs[i]));
+    }
+
+    glDisable(GL_BLEND);
+    glBindVertexArray(fullscreenVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    glEnable(GL_BLEND);
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(i));
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void Renderer::drawBlur(RenderResource source, float stepX, float stepY) {
+    GLuint program = shaderPrograms["blur"];
+    glUseProgram(program);
+    glUniform1i(getPostProcessUniform("blur", "sourceTexture"), 0);
+    glUniform2f(getPostProcessUniform("blur", "texelStep"), stepX, stepY);
+    drawFullscreen({ source });
+}
+
+void Renderer::buildRenderGraph(int width, int height) {
+    renderGraph.reset();
+
+    // Bright pass and bloom blur run at half resolution
+    RenderTargetDesc fullSize = { width, height, GL_RGBA16F };
+    RenderTargetDesc halfSize = { std::max(width / 2, 1), std::max(height / 2, 1), GL_RGBA16F };
+
+    RenderResource scene = renderGraph.createTexture("scene", fullSize);
+    RenderResource bright = renderGraph.createTexture("bright", halfSize);
+    RenderResource bloomBlurX = renderGraph.createTexture("bloomBlurX", halfSize);
+    RenderResource bloom = renderGraph.createTexture("bloom", halfSize);
+    RenderResource sceneBlurX = renderGraph.createTexture("sceneBlurX", fullSize);
+    RenderResource sceneBlur = renderGraph.createTexture("sceneBlur", fullSize);
+    RenderResource backbuffer = renderGraph.importBackbuffer("backbuffer", width, height);
+
+    float halfStepX = 1.0f / halfSize.width;
+    float halfStepY = 1.0f / halfSize.height;
+    float fullStepX = 1.0f / fullSize.width;
+    float fullStepY = 1.0f / fullSize.height;
+
+    renderGraph.addPass("scene", {}, scene, [this]() {
+        drawScene();
+    });
+
+    // Every effect is always declared; the graph culls whatever the composite does not read
+    renderGraph.addPass("bright", { scene }, bright, [this, scene]() {
+        GLuint program = shaderPrograms["bright"];
+        glUseProgram(program);
+        glUniform1i(getPostProcessUniform("bright", "sourceTexture"), 0);
+        glUniform1f(getPostProcessUniform("bright", "threshold"), bloomThreshold);
+        drawFullscreen({ scene });
+    });
+    renderGraph.addPass("bloomBlurX", { bright }, bloomBlurX, [this, bright, halfStepX]() {
+        drawBlur(bright, halfStepX, 0.0f);
+    });
+    renderGraph.addPass("bloomBlurY", { bloomBlurX }, bloom, [this, bloomBlurX, halfStepY]() {
+        drawBlur(bloomBlurX, 0.0f, halfStepY);
+    });
+    renderGraph.addPass("sceneBlurX", { scene }, sceneBlurX, [this, scene, fullStepX]() {
+        drawBlur(scene, fullStepX, 0.0f);
+    });
+    renderGraph.addPass("sceneBlurY", { sceneBlurX }, sceneBlur, [this, sceneBlurX, fullStepY]() {
+        drawBlur(sceneBlurX, 0.0f, fullStepY);
+    });
+
+    std::vector<RenderResource> compositeInputs = { blurEnabled ? sceneBlur : scene };
+    if (bloomEnabled) {
+        compositeInputs.push_back(bloom);
+    }
+    renderGraph.addPass("composite", compositeInputs, backbuffer, [this, compositeInputs]() {
+        GLuint program = shaderPrograms["composite"];
+        glUseProgram(program);
+        glUniform1i(getPostProcessUniform("composite", "sceneTexture"), 0);
+        glUniform1i(getPostProcessUniform("composite", "bloomTexture"), 1);
+        glUniform1i(getPostProcessUniform("composite", "bloomEnabled"), bloomEnabled);
+        glUniform1i(getPostProcessUniform("composite", "toneMapping"), toneMappingEnabled);
+        glUniform1f(getPostProcessUniform("composite", "exposure"), exposure);
+        drawFullscreen(compositeInputs);
+    });
+}
+
 void Renderer::cleanup() {
     cleanupShapes();
     if (triangleVAO) {
@@ -405,8 +690,13 @@ void Renderer::cleanup() {
             glDeleteProgram(program);
         }
     }
+    renderQueue.clear();
+    sprites.clear();
+    textureLoader.cleanup();
+    renderGraph.cleanup();
     shaderPrograms.clear();
     colorUniformLocations.clear();
+    postProcessUniformLocations.clear();
 
     if (window) {
         glfwDestroyWindow(window);
@@ -3,6 +3,10 @@
 #include <GLFW/glfw3.h>
 #include <string>
 #include <map>
+#include <vector>
+#include "render_graph.h"
+#include "render_queue.h"
+#include "texture_loader.h"
 
 class Renderer {
 public:
@@ -11,6 +15,7 @@ public:
 
     bool init();
     bool loadShaders(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath);
+    bool loadPostProcessShaders(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath);
     void render();
     void cleanup();
     GLFWwindow* getWindow() { return window; }  // Getter for the window
@@ -31,6 +36,22 @@ public:
         backgroundColor[2] = b;
     }
     void setAnimationSpeed(float speed) { animationSpeed = speed; }
+    void setRenderQueueSorting(bool enabled) { renderQueue.setSortingEnabled(enabled); }
+    const RenderQueueStats& getRenderQueueStats() const { return renderQueue.getStats(); }
+
+    // Sprite methods
+    int loadSpriteTexture(const std::string& filePath);  // Returns a texture handle or -1
+    void addSprite(int texture, float x, float y, float width, float height);  // Centre and size in NDC
+    void setShowSprites(bool enabled) { showSprites = enabled; }
+    void setTextureUploadBudget(size_t bytesPerFrame) { textureLoader.setUploadBudget(bytesPerFrame); }
+    const TextureLoaderStats& getTextureLoaderStats() const { return textureLoader.getStats(); }
+
+    // Post-processing methods
+    void setBlurEnabled(bool enabled) { blurEnabled = enabled; }
+    void setBloomEnabled(bool enabled) { bloomEnabled = enabled; }
+    void setToneMappingEnabled(bool enabled) { toneMappingEnabled = enabled; }
+    void setExposure(float value) { exposure = value; }
+    const RenderGraphStats& getRenderGraphStats() const { return renderGraph.getStats(); }
 
 private:
     GLFWwindow* window;
@@ -41,8 +62,13 @@ private:
     GLuint squareVBO;
     GLuint circleVAO;
     GLuint circleVBO;
+    GLuint spriteVAO;
+    GLuint spriteVBO;
+    GLuint fullscreenVAO;
     
     std::string loadShader(const std::string& filePath);
+    GLuint compileProgram(const std::string& vertexPath, const std::string& fragmentPath);
+    GLint getPostProcessUniform(const std::string& shader, const std::string& uniform);
     void checkShaderCompileErrors(GLuint shader, const std::string& type);
     void checkProgramLinkErrors(GLuint program);
     void updateFPS();  // Update FPS calculation
@@ -51,9 +77,16 @@ private:
     void createSquare();
     void createCircle();
     void createTriangle();
+    void createSpriteBatch();
+    void submitSprites();
+    void drawScene();
+    void drawFullscreen(const std::vector<RenderResource>& inputs);
+    void drawBlur(RenderResource source, float stepX, float stepY);
+    void buildRenderGraph(int width, int height);
     void cleanupShapes();
 
     std::map<std::string, GLint> colorUniformLocations;  // Map to store uniform locations for each shader
+    std::map<std::string, std::map<std::string, GLint>> postProcessUniformLocations;  // Uniform locations of each post-processing shader
     float time;  // Add time tracking
     int windowWidth;   // Add window dimensions
     int windowHeight;
@@ -73,4 +106,25 @@ private:
     float backgroundColor[3];
     float shapeColor[3];
     int currentShape;
+
+    RenderQueue renderQueue;  // Sorted draw submission for the frame
+
+    // Sprite members
+    struct Sprite {
+        int texture;  // Layer in the loader's texture array
+        float x, y;
+        float width, height;
+    };
+    TextureLoader textureLoader;
+    std::vector<Sprite> sprites;
+    std::vector<float> spriteVertices;  // Rebuilt every frame for the sprite batch
+    bool showSprites;
+
+    // Post-processing members
+    RenderGraph renderGraph;
+    bool blurEnabled;
+    bool bloomEnabled;
+    bool toneMappingEnabled;
+    float exposure;
+    float bloomThreshold;
 };
\ No newline at end of file
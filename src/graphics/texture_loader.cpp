@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#include "texture_loader.h"
+
+TextureLoader::TextureLoader(int layerSize, int maxLayers, int workerCount)
+    : layerSize(layerSize),
+      maxLayers(maxLayers),
+      workerCount(workerCount),
+      uploadBudget(256 * 1024),
+      texture(0),
+      pixelBuffers{0, 0},
+      nextPixelBuffer(0),
+      layers(),
+      uploads(),
+      workers(),
+      jobs(),
+      decoded(),
+      decodesInFlight(0),
+      stopping(false),
+      stats() {
+}
+
+TextureLoader::~TextureLoader() {
+    cleanup();
+}
+
+bool TextureLoader::init() {
+    // Drop errors left over from earlier calls (e.g. glewInit) so the check below only sees ours
+    while (glGetError() != GL_NO_ERROR) {
+    }
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, layerSize, layerSize, maxLayers,
+                 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    if (glGetError() != GL_NO_ERROR) {
+        std::cerr << "Failed to create sprite texture array" << std::endl;
+        return false;
+    }
+
+    glGenBuffers(2, pixelBuffers);
+    layers.assign(maxLayers, LayerInfo{TextureState::Empty, 0, 0});
+
+    stopping = false;
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&TextureLoader::workerLoop, this);
+    }
+    return true;
+}
+
+void TextureLoader::cleanup() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopping = true;
+        jobs.clear();
+    }
+    jobCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    decoded.clear();
+    uploads.clear();
+    layers.clear();
+
+    if (pixelBuffers[0]) {
+        glDeleteBuffers(2, pixelBuffers);
+        pixelBuffers[0] = 0;
+        pixelBuffers[1] = 0;
+    }
+    if (texture) {
+        glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+}
+
+int TextureLoader::load(const std::string& filePath) {
+    auto freeLayer = std::find_if(layers.begin(), layers.end(), [](const LayerInfo& info) {
+        return info.state == TextureState::Empty;
+    });
+    if (freeLayer == layers.end()) {
+        std::cerr << "Sprite texture array is full, cannot load: " << filePath << std::endl;
+        return -1;
+    }
+
+    int layer = static_cast<int>(freeLayer - layers.begin());
+    freeLayer->state = TextureState::Loading;
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobs.push_back(DecodeJob{layer, filePath});
+    }
+    jobCondition.notify_one();
+    return layer;
+}
+
+void TextureLoader::workerLoop() {
+    while (true) {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobCondition.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            decodesInFlight++;
+        }
+
+        DecodedImage image{job.layer, 0, 0, {}, 0};
+        int channels = 0;
+        unsigned char* data = stbi_load(job.filePath.c_str(), &image.width, &image.height, &channels, STBI_rgb_alpha);
+        if (!data) {
+            std::cerr << "Failed to decode texture: " << job.filePath << " (" << stbi_failure_reason() << ")" << std::endl;
+        } else if (image.width > layerSize || image.height > layerSize) {
+            std::cerr << "Texture " << job.filePath << " is larger than the " << layerSize << "x" << layerSize
+                      << " sprite layer size" << std::endl;
+        } else {
+            image.pixels.assign(data, data + static_cast<size_t>(image.width) * image.height * 4);
+        }
+        stbi_image_free(data);
+
+        std::lock_guard<std::mutex> lock(jobMutex);
+        decoded.push_back(std::move(image));
+        decodesInFlight--;
+    }
+}
+
+size_t TextureLoader::uploadRows(DecodedImage& image, size_t budget) {
+    size_t rowBytes = static_cast<size_t>(image.width) * 4;
+    size_t rowsLeft = image.height - image.rowsUploaded;
+    // Always make progress, even if a single row is over budget
+    size_t rows = std::clamp(budget / rowBytes, static_cast<size_t>(1), rowsLeft);
+    size_t chunkBytes = rows * rowBytes;
+
+    GLuint pixelBuffer = pixelBuffers[nextPixelBuffer];
+    nextPixelBuffer = 1 - nextPixelBuffer;
+
+    // Orphan the previous storage so the driver does not stall on an in-flight copy
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, chunkBytes, nullptr, GL_STREAM_DRAW);
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, chunkBytes,
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped) {
+        std::memcpy(mapped, image.pixels.data() + image.rowsUploaded * rowBytes, chunkBytes);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, static_cast<GLint>(image.rowsUploaded), image.layer,
+                        image.width, static_cast<GLsizei>(rows), 1, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    } else {
+        // Fall back to a direct upload from client memory
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, static_cast<GLint>(image.rowsUploaded), image.layer,
+                        image.width, static_cast<GLsizei>(rows), 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                        image.pixels.data() + image.rowsUploaded * rowBytes);
+    }
+
+    image.rowsUploaded += rows;
+    return chunkBytes;
+}
+
+void TextureLoader::update() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stats.pendingDecodes = static_cast<int>(jobs.size()) + decodesInFlight;
+        while (!decoded.empty()) {
+            uploads.push_back(std::move(decoded.front()));
+            decoded.pop_front();
+        }
+    }
+
+    size_t uploaded = 0;
+    if (!uploads.empty()) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        while (!uploads.empty() && uploaded < uploadBudget) {
+            DecodedImage& image = uploads.front();
+            LayerInfo& info = layers[image.layer];
+
+            if (image.pixels.empty()) {
+                info.state = TextureState::Failed;
+                uploads.pop_front();
+                continue;
+            }
+
+            uploaded += uploadRows(image, uploadBudget - uploaded);
+            if (image.rowsUploaded == static_cast<size_t>(image.height)) {
+                info.state = TextureState::Ready;
+                info.width = image.width;
+                info.height = image.height;
+                uploads.pop_front();
+            }
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+
+    stats.bytesUploadedLastFrame = uploaded;
+    stats.pendingUploads = static_cast<int>(uploads.size());
+    stats.pendingUploadBytes = 0;
+    for (const DecodedImage& image : uploads) {
+        stats.pendingUploadBytes += (image.height - image.rowsUploaded) * static_cast<size_t>(image.width) * 4;
+    }
+}
+
+TextureState TextureLoader::getState(int layer) const {
+    if (layer < 0 || layer >= static_cast<int>(layers.size())) {
+        return TextureState::Failed;
+    }
+    return layers[layer].state;
+}
+
+void TextureLoader::getUVScale(int layer, float& u, float& v) const {
+    u = 0.0f;
+    v = 0.0f;
+    if (getState(layer) == TextureState::Ready) {
+        // Stop half a texel short of the image edge so linear filtering never
+        // blends in the uninitialised rest of the layer
+        u = (layers[layer].width - 0.5f) / layerSize;
+        v = (layers[layer].height - 0.5f) / layerSize;
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <GL/glew.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class TextureState {
+    Empty,
+    Loading,   // Decoding on a worker or waiting for upload
+    Ready,
+    Failed
+};
+
+// Per-frame numbers reported by the loader
+struct TextureLoaderStats {
+    int pendingDecodes = 0;
+    int pendingUploads = 0;
+    size_t pendingUploadBytes = 0;
+    size_t bytesUploadedLastFrame = 0;
+};
+
+// Loads images into the layers of a single GL_TEXTURE_2D_ARRAY. Files are
+// decoded on worker threads; the pixels are then streamed to the GPU through
+// pixel buffer objects a few rows at a time, never exceeding the per-frame
+// upload budget. Because every sprite samples the same array texture, sprites
+// can be drawn in one batch whatever image they show.
+class TextureLoader {
+public:
+    TextureLoader(int layerSize, int maxLayers, int workerCount);
+    ~TextureLoader();
+
+    bool init();     // Needs a current GL context
+    void cleanup();
+
+    // Queue a file for loading; returns its array layer or -1 if the array is full
+    int load(const std::string& filePath);
+
+    // Collect decoded images and upload as much as the budget allows. Call once per frame.
+    void update();
+
+    void setUploadBudget(size_t bytesPerFrame) { uploadBudget = bytesPerFrame; }
+    size_t getUploadBudget() const { return uploadBudget; }
+
+    GLuint getTexture() const { return texture; }
+    TextureState getState(int layer) const;
+    // Largest texture coordinates inside the image, inset by half a texel from its edge
+    void getUVScale(int layer, float& u, float& v) const;
+    const TextureLoaderStats& getStats() const { return stats; }
+
+private:
+    struct DecodeJob {
+        int layer;
+        std::string filePath;
+    };
+
+    struct DecodedImage {
+        int layer;
+        int width;
+        int height;
+        std::vector<unsigned char> pixels;  // RGBA8, empty if decoding failed
+        size_t rowsUploaded;
+    };
+
+    struct LayerInfo {
+        TextureState state;
+        int width;
+        int height;
+    };
+
+    void workerLoop();
+    size_t uploadRows(DecodedImage& image, size_t budget);
+
+    int layerSize;
+    int maxLayers;
+    int workerCount;
+    size_t uploadBudget;  // Bytes per frame
+
+    GLuint texture;
+    GLuint pixelBuffers[2];  // Alternated so a chunk never waits on the previous copy
+    int nextPixelBuffer;
+
+    std::vector<LayerInfo> layers;      // Main thread only
+    std::deque<DecodedImage> uploads;   // Main thread only
+
+    // Shared with the workers
+    std::vector<std::thread> workers;
+    std::mutex jobMutex;
+    std::condition_variable jobCondition;
+    std::deque<DecodeJob> jobs;
+    std::deque<DecodedImage> decoded;
+    int decodesInFlight;  // Jobs a worker has taken but not finished
+    bool stopping;
+
+    TextureLoaderStats stats;
+};
@@ -3,7 +3,9 @@
 
 GUIManager::GUIManager(GLFWwindow* window) 
     : window(window), showDemoWindow(false), showControlsWindow(true),
-      animationSpeed(1.0f), rainbowMode(true), currentShape(0) {
+      animationSpeed(1.0f), rainbowMode(true), currentShape(0), sortRenderQueue(true),
+      showSprites(true), uploadBudgetKB(256),
+      blurEnabled(false), bloomEnabled(false), toneMappingEnabled(false), exposure(1.0f) {
     backgroundColor[0] = 0.2f;
     backgroundColor[1] = 0.3f;
     backgroundColor[2] = 0.3f;
@@ -68,6 +70,50 @@ void GUIManager::render(Renderer* renderer) {
             renderer->setFPSLimit(targetFPS);
         }
 
+        // Render queue controls
+        if (ImGui::Checkbox("Sort Draw Calls", &sortRenderQueue)) {
+            renderer->setRenderQueueSorting(sortRenderQueue);
+        }
+        const RenderQueueStats& queueStats = renderer->getRenderQueueStats();
+        int executedChanges = queueStats.programChanges + queueStats.vaoChanges +
+                              queueStats.textureChanges + queueStats.blendChanges;
+        ImGui::Text("Draw items: %d", static_cast<int>(queueStats.itemCount));
+        ImGui::Text("State changes: %d (unsorted %d, sorted %d)", executedChanges,
+                    queueStats.unsortedStateChanges, queueStats.sortedStateChanges);
+        ImGui::Text("State changes saved: %d", queueStats.unsortedStateChanges - executedChanges);
+
+        // Sprite and texture streaming controls
+        if (ImGui::Checkbox("Show Sprites", &showSprites)) {
+            renderer->setShowSprites(showSprites);
+        }
+        if (ImGui::SliderInt("Upload Budget (KB/frame)", &uploadBudgetKB, 4, 1024)) {
+            renderer->setTextureUploadBudget(static_cast<size_t>(uploadBudgetKB) * 1024);
+        }
+        const TextureLoaderStats& loaderStats = renderer->getTextureLoaderStats();
+        ImGui::Text("Textures decoding: %d, uploading: %d (%d KB left)", loaderStats.pendingDecodes,
+                    loaderStats.pendingUploads, static_cast<int>(loaderStats.pendingUploadBytes / 1024));
+        ImGui::Text("Uploaded last frame: %d KB", static_cast<int>(loaderStats.bytesUploadedLastFrame / 1024));
+
+        // Post-processing controls
+        if (ImGui::Checkbox("Blur", &blurEnabled)) {
+            renderer->setBlurEnabled(blurEnabled);
+        }
+        if (ImGui::Checkbox("Bloom", &bloomEnabled)) {
+            renderer->setBloomEnabled(bloomEnabled);
+        }
+        if (ImGui::Checkbox("Tone Mapping", &toneMappingEnabled)) {
+            renderer->setToneMappingEnabled(toneMappingEnabled);
+        }
+        if (ImGui::SliderFloat("Exposure", &exposure, 0.1f, 5.0f)) {
+            renderer->setExposure(exposure);
+        }
+        const RenderGraphStats& graphStats = renderer->getRenderGraphStats();
+        ImGui::Text("Render passes: %d (%d culled)", graphStats.passCount - graphStats.culledPassCount,
+                    graphStats.culledPassCount);
+        ImGui::Text("Render targets: %d for %d transient textures", graphStats.physicalCount, graphStats.transientCount);
+        ImGui::Text("Target memory: %.2f MB peak, %.2f MB saved by aliasing",
+                    graphStats.peakBytes / (1024.0 * 1024.0), graphStats.savedBytes / (1024.0 * 1024.0));
+
         ImGui::End();
     }
 
@@ -29,4 +29,11 @@ private:
     float shapeColor[3];
     bool rainbowMode;
     int currentShape;
+    bool sortRenderQueue;
+    bool showSprites;
+    int uploadBudgetKB;
+    bool blurEnabled;
+    bool bloomEnabled;
+    bool toneMappingEnabled;
+    float exposure;
 }; 
\ No newline at end of file
@@ -45,12 +45,24 @@ int main() {
 
     // Load all shaders
     if (!renderer.loadShaders("default", "shaders/default_vertex.glsl", "shaders/default_fragment.glsl") ||
-        !renderer.loadShaders("circle", "shaders/circle_vertex.glsl", "shaders/circle_fragment.glsl")) {
+        !renderer.loadShaders("circle", "shaders/circle_vertex.glsl", "shaders/circle_fragment.glsl") ||
+        !renderer.loadShaders("sprite", "shaders/sprite_vertex.glsl", "shaders/sprite_fragment.glsl") ||
+        !renderer.loadPostProcessShaders("bright", "shaders/fullscreen_vertex.glsl", "shaders/bright_fragment.glsl") ||
+        !renderer.loadPostProcessShaders("blur", "shaders/fullscreen_vertex.glsl", "shaders/blur_fragment.glsl") ||
+        !renderer.loadPostProcessShaders("composite", "shaders/fullscreen_vertex.glsl", "shaders/composite_fragment.glsl")) {
         std::cerr << "Failed to load shaders." << std::endl;
         return -1;
     }
     std::cout << "Shaders loaded successfully" << std::endl;
 
+    // Load sprite textures in the background and place a sprite in each corner
+    int spriteTexture = renderer.loadSpriteTexture("textures/sprite.png");
+    renderer.addSprite(spriteTexture, -0.75f,  0.7f, 0.3f, 0.4f);
+    renderer.addSprite(spriteTexture,  0.75f,  0.7f, 0.3f, 0.4f);
+    renderer.addSprite(spriteTexture, -0.75f, -0.7f, 0.3f, 0.4f);
+    renderer.addSprite(spriteTexture,  0.75f, -0.7f, 0.3f, 0.4f);
+    std::cout << "Sprite texture queued for loading" << std::endl;
+
     // Set FPS limit to 60
     renderer.setFPSLimit(60);
     std::cout << "FPS limit set to 60" << std::endl;